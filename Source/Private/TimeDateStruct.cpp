@@ -1,7 +0,0 @@
-// For copyright see LICENSE in EnvironmentProject root dir, or:
-//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
-
-#include "TimeDateStruct.h"
-
-// This file must be present for FTimeDateStruct & FLocation
-
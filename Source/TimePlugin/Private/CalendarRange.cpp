@@ -0,0 +1,81 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#include "CalendarRange.h"
+
+FCalendarRange::FCalendarRange(const FDateTime& InStart, const FDateTime& InEnd, ECalendarStep InStep, EDayOfWeek InWeekStart)
+	: Step(InStep)
+{
+	SetFirstBoundary(InStart, InWeekStart);
+	Count = CountBoundariesBefore(InEnd);
+}
+
+FCalendarRange::FCalendarRange(const FDateTime& InStart, int32 InCount, ECalendarStep InStep, EDayOfWeek InWeekStart)
+	: Step(InStep)
+{
+	SetFirstBoundary(InStart, InWeekStart);
+	Count = FMath::Clamp(InCount, 0, CountBoundariesBefore(FDateTime::MaxValue()));
+}
+
+FDateTime FCalendarRange::operator[](int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+
+	switch (Step)
+	{
+	case ECalendarStep::Week:
+		return First + FTimespan(7 * (int64)Index * ETimespan::TicksPerDay);
+	case ECalendarStep::Month:
+	{
+		const int32 MonthIndex = FirstMonthIndex + Index;
+		return FDateTime(MonthIndex / 12, MonthIndex % 12 + 1, 1);
+	}
+	default:
+		return First + FTimespan((int64)Index * ETimespan::TicksPerDay);
+	}
+}
+
+void FCalendarRange::SetFirstBoundary(const FDateTime& InStart, EDayOfWeek InWeekStart)
+{
+	//Start at the first midnight that is not before InStart
+	First = InStart.GetDate();
+	if (First < InStart)
+	{
+		First += FTimespan(ETimespan::TicksPerDay);
+	}
+
+	if (Step == ECalendarStep::Week)
+	{
+		const int32 DaysToWeekStart = ((int32)InWeekStart - (int32)First.GetDayOfWeek() + 7) % 7;
+		First += FTimespan(DaysToWeekStart * ETimespan::TicksPerDay);
+	}
+	else if (Step == ECalendarStep::Month)
+	{
+		int32 Year, Month, Day;
+		First.GetDate(Year, Month, Day);
+		FirstMonthIndex = Year * 12 + (Month - 1) + (Day > 1 ? 1 : 0);
+
+		//No month starts after December 9999, leave the range empty
+		First = FirstMonthIndex / 12 > 9999 ? FDateTime::MaxValue() : FDateTime(FirstMonthIndex / 12, FirstMonthIndex % 12 + 1, 1);
+	}
+}
+
+int32 FCalendarRange::CountBoundariesBefore(const FDateTime& InEnd) const
+{
+	if (InEnd <= First)
+	{
+		return 0;
+	}
+
+	if (Step == ECalendarStep::Month)
+	{
+		int32 Year, Month, Day;
+		InEnd.GetDate(Year, Month, Day);
+		const int32 EndMonthIndex = Year * 12 + (Month - 1);
+		//The start of InEnd's own month only counts if InEnd is past it
+		return EndMonthIndex - FirstMonthIndex + (InEnd > FDateTime(Year, Month, 1) ? 1 : 0);
+	}
+
+	const int64 StepTicks = (Step == ECalendarStep::Week ? 7 : 1) * ETimespan::TicksPerDay;
+	return (int32)(((InEnd - First).GetTicks() + StepTicks - 1) / StepTicks);
+}
@@ -0,0 +1,305 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#include "TimeAlmanac.h"
+#include "TimePlugin.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Paths.h"
+
+// File layout: one header, then NumBands blocks of NumDays records, all little endian
+struct FTimeAlmanacHeader
+{
+	uint32 Magic;
+	uint16 Version;
+	uint16 RecordSize;
+	int32 FirstJulianDay;
+	int32 NumDays;
+	float FirstLatitude;
+	float BandSize;
+	int32 NumBands;
+};
+
+// Sunrise and sunset are in units of 2 seconds after midnight, MoonPhase in 1/256ths of a cycle
+struct FTimeAlmanacRecord
+{
+	uint16 Sunrise;
+	uint16 Sunset;
+	uint8 MoonPhase;
+	uint8 Flags;
+};
+
+static_assert(sizeof(FTimeAlmanacHeader) == 28, "Almanac header must match the file layout");
+static_assert(sizeof(FTimeAlmanacRecord) == 6, "Almanac record must match the file layout");
+
+static const uint32 ALMANAC_MAGIC = 0x4D4C4154; // "TALM"
+// 2: seasons are stored for the northern hemisphere and flipped by the looked up latitude
+static const uint16 ALMANAC_VERSION = 2;
+
+enum EAlmanacRecordFlags : uint8
+{
+	ARF_SeasonMask = 0x3,
+	ARF_SeasonStart = 1 << 2,
+	ARF_PolarNight = 1 << 3,
+	ARF_MidnightSun = 1 << 4,
+};
+
+static const double SYNODIC_MONTH = 29.530588853;
+// A known new moon (Jan 6, 2000 @ 14:24 UTC)
+static const double NEW_MOON_EPOCH = 2451550.1;
+
+
+static double WrapDegrees(double Degrees)
+{
+	return Degrees - 360.0 * FMath::FloorToDouble(Degrees / 360.0);
+}
+
+static float SinDeg(double Degrees)
+{
+	return FMath::Sin(FMath::DegreesToRadians((float)WrapDegrees(Degrees)));
+}
+
+/**
+ * The March equinox, June solstice, September equinox and December solstice of a year as Julian Day Numbers.
+ * Mean values from Meeus, Chapter 27: Table 27.A before year 1000, Table 27.B from 1000 to 3000.
+ * Meeus gives no series past 3000, later years extrapolate Table 27.B and drift slowly.
+ */
+static void GetSeasonStarts(int32 Year, int32 OutStarts[4])
+{
+	double JDE[4];
+
+	if (Year < 1000)
+	{
+		const double Y = Year / 1000.0;
+		const double Y2 = Y * Y;
+		const double Y3 = Y2 * Y;
+		const double Y4 = Y3 * Y;
+
+		JDE[0] = 1721139.29189 + 365242.13740 * Y + 0.06134 * Y2 + 0.00111 * Y3 - 0.00071 * Y4;
+		JDE[1] = 1721233.25401 + 365241.72562 * Y - 0.05323 * Y2 + 0.00907 * Y3 + 0.00025 * Y4;
+		JDE[2] = 1721325.70455 + 365242.49558 * Y - 0.11677 * Y2 - 0.00297 * Y3 + 0.00074 * Y4;
+		JDE[3] = 1721414.39987 + 365242.88257 * Y - 0.00769 * Y2 - 0.00933 * Y3 - 0.00006 * Y4;
+	}
+	else
+	{
+		const double Y = (Year - 2000) / 1000.0;
+		const double Y2 = Y * Y;
+		const double Y3 = Y2 * Y;
+		const double Y4 = Y3 * Y;
+
+		JDE[0] = 2451623.80984 + 365242.37404 * Y + 0.05169 * Y2 - 0.00411 * Y3 - 0.00057 * Y4;
+		JDE[1] = 2451716.56767 + 365241.62603 * Y + 0.00325 * Y2 + 0.00888 * Y3 - 0.00030 * Y4;
+		JDE[2] = 2451810.21715 + 365242.01767 * Y - 0.11575 * Y2 + 0.00337 * Y3 + 0.00078 * Y4;
+		JDE[3] = 2451900.05952 + 365242.74049 * Y - 0.06223 * Y2 - 0.00823 * Y3 + 0.00032 * Y4;
+	}
+
+	for (int32 i = 0; i < 4; i++)
+	{
+		OutStarts[i] = (int32)FMath::FloorToDouble(JDE[i] + 0.5);
+	}
+}
+
+
+FTimeAlmanac::FTimeAlmanac()
+{
+}
+
+FTimeAlmanac::~FTimeAlmanac()
+{
+	Close();
+}
+
+bool FTimeAlmanac::Open(const FString& Path)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Path))
+	{
+		return false;
+	}
+
+	MappedHandle.Reset(PlatformFile.OpenMapped(*Path));
+	if (!MappedHandle.IsValid() || MappedHandle->GetFileSize() < (int64)sizeof(FTimeAlmanacHeader))
+	{
+		UE_LOG(LogTimePlugin, Warning, TEXT("%s:: Could not map almanac %s, using live computation"), *PLUGIN_FUNC_LINE, *Path);
+		Close();
+		return false;
+	}
+
+	MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+	if (!MappedRegion.IsValid())
+	{
+		UE_LOG(LogTimePlugin, Warning, TEXT("%s:: Could not map almanac %s, using live computation"), *PLUGIN_FUNC_LINE, *Path);
+		Close();
+		return false;
+	}
+
+	const FTimeAlmanacHeader* Header = reinterpret_cast<const FTimeAlmanacHeader*>(MappedRegion->GetMappedPtr());
+	const int64 ExpectedSize = sizeof(FTimeAlmanacHeader) + (int64)Header->NumBands * Header->NumDays * sizeof(FTimeAlmanacRecord);
+
+	if (Header->Magic != ALMANAC_MAGIC || Header->Version != ALMANAC_VERSION || Header->RecordSize != sizeof(FTimeAlmanacRecord)
+		|| Header->NumDays <= 0 || Header->NumBands <= 0 || Header->BandSize <= 0.0f || MappedRegion->GetMappedSize() < ExpectedSize)
+	{
+		UE_LOG(LogTimePlugin, Warning, TEXT("%s:: Almanac %s is invalid or out of date, using live computation"), *PLUGIN_FUNC_LINE, *Path);
+		Close();
+		return false;
+	}
+
+	FirstJulianDay = Header->FirstJulianDay;
+	NumDays = Header->NumDays;
+	FirstLatitude = Header->FirstLatitude;
+	BandSize = Header->BandSize;
+	NumBands = Header->NumBands;
+	Records = reinterpret_cast<const FTimeAlmanacRecord*>(Header + 1);
+
+	UE_LOG(LogTimePlugin, Display, TEXT("%s:: Mapped almanac %s (%d days, %d latitude bands)"), *PLUGIN_FUNC_LINE, *Path, NumDays, NumBands);
+	return true;
+}
+
+void FTimeAlmanac::Close()
+{
+	Records = nullptr;
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+FTimeAlmanacDay FTimeAlmanac::GetDay(int32 JulianDayNumber, float Latitude) const
+{
+	const int32 Day = JulianDayNumber - FirstJulianDay;
+	const int32 Band = IsOpen() ? FMath::RoundToInt((Latitude - FirstLatitude) / BandSize) : -1;
+
+	if (Day < 0 || Day >= NumDays || Band < 0 || Band >= NumBands)
+	{
+		return ComputeDay(JulianDayNumber, Latitude);
+	}
+
+	const FTimeAlmanacRecord& Record = Records[(int64)Band * NumDays + Day];
+
+	FTimeAlmanacDay Result;
+	Result.SunriseMinutes = Record.Sunrise / 30.0f;
+	Result.SunsetMinutes = Record.Sunset / 30.0f;
+	Result.MoonPhase = Record.MoonPhase / 256.0f;
+	//Records hold the northern season, the hemisphere comes from the looked up latitude, not the band's
+	const int32 NorthernSeason = Record.Flags & ARF_SeasonMask;
+	Result.Season = Latitude < 0.0f ? (NorthernSeason + 2) % 4 : NorthernSeason;
+	Result.bSeasonStart = (Record.Flags & ARF_SeasonStart) != 0;
+	Result.bPolarNight = (Record.Flags & ARF_PolarNight) != 0;
+	Result.bMidnightSun = (Record.Flags & ARF_MidnightSun) != 0;
+	return Result;
+}
+
+FTimeAlmanacDay FTimeAlmanac::ComputeDay(int32 JulianDayNumber, float Latitude)
+{
+	FTimeAlmanacDay Result;
+
+	// Sunrise equation at longitude 0, the result is mean solar time which only needs a longitude shift to be local
+	const double n = JulianDayNumber - ATimeManager::J2000;
+	const double M = WrapDegrees(357.5291 + 0.98560028 * n);
+	const double C = 1.9148 * SinDeg(M) + 0.0200 * SinDeg(2.0 * M) + 0.0003 * SinDeg(3.0 * M);
+	const double Lambda = WrapDegrees(M + C + 180.0 + 102.9372);
+	const float TransitMinutes = 720.0f + 1440.0f * (0.0053f * SinDeg(M) - 0.0069f * SinDeg(2.0 * Lambda));
+
+	const float SinDeclination = SinDeg(Lambda) * SinDeg(23.4397);
+	const float CosDeclination = FMath::Sqrt(1.0f - SinDeclination * SinDeclination);
+	const float LatitudeRad = FMath::DegreesToRadians(FMath::Clamp(Latitude, -89.9f, 89.9f));
+	const float CosHourAngle = (SinDeg(-0.833) - FMath::Sin(LatitudeRad) * SinDeclination) / (FMath::Cos(LatitudeRad) * CosDeclination);
+
+	if (CosHourAngle > 1.0f)
+	{
+		Result.bPolarNight = true;
+	}
+	else if (CosHourAngle < -1.0f)
+	{
+		Result.bMidnightSun = true;
+	}
+	else
+	{
+		// 4 minutes of time per degree of hour angle
+		const float HalfDayMinutes = 4.0f * FMath::RadiansToDegrees(FMath::Acos(CosHourAngle));
+		Result.SunriseMinutes = FMath::Fmod(TransitMinutes - HalfDayMinutes + 1440.0f, 1440.0f);
+		Result.SunsetMinutes = FMath::Fmod(TransitMinutes + HalfDayMinutes, 1440.0f);
+	}
+
+	const double MoonAge = (JulianDayNumber - NEW_MOON_EPOCH) / SYNODIC_MONTH;
+	Result.MoonPhase = (float)(MoonAge - FMath::FloorToDouble(MoonAge));
+
+	int32 SeasonStarts[4];
+	GetSeasonStarts(FDateTime::FromJulianDay(JulianDayNumber).GetYear(), SeasonStarts);
+
+	// Northern hemisphere: winter until the March equinox, then spring, summer, autumn, winter
+	int32 Season = 3;
+	for (int32 i = 0; i < 4; i++)
+	{
+		if (JulianDayNumber >= SeasonStarts[i])
+		{
+			Season = i;
+		}
+		if (JulianDayNumber == SeasonStarts[i])
+		{
+			Result.bSeasonStart = true;
+		}
+	}
+	Result.Season = Latitude < 0.0f ? (Season + 2) % 4 : Season;
+
+	return Result;
+}
+
+bool FTimeAlmanac::WriteFile(const FString& Path, int32 InFirstJulianDay, int32 InNumDays, float InFirstLatitude, float InBandSize, int32 InNumBands)
+{
+	if (InNumDays <= 0 || InNumBands <= 0 || InBandSize <= 0.0f)
+	{
+		UE_LOG(LogTimePlugin, Warning, TEXT("%s:: Almanac needs at least one day and one latitude band"), *PLUGIN_FUNC_LINE);
+		return false;
+	}
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Ar.IsValid())
+	{
+		UE_LOG(LogTimePlugin, Warning, TEXT("%s:: Could not create almanac %s"), *PLUGIN_FUNC_LINE, *Path);
+		return false;
+	}
+
+	FTimeAlmanacHeader Header;
+	Header.Magic = ALMANAC_MAGIC;
+	Header.Version = ALMANAC_VERSION;
+	Header.RecordSize = sizeof(FTimeAlmanacRecord);
+	Header.FirstJulianDay = InFirstJulianDay;
+	Header.NumDays = InNumDays;
+	Header.FirstLatitude = InFirstLatitude;
+	Header.BandSize = InBandSize;
+	Header.NumBands = InNumBands;
+
+	*Ar << Header.Magic << Header.Version << Header.RecordSize << Header.FirstJulianDay << Header.NumDays
+		<< Header.FirstLatitude << Header.BandSize << Header.NumBands;
+
+	for (int32 Band = 0; Band < InNumBands; Band++)
+	{
+		const float Latitude = InFirstLatitude + Band * InBandSize;
+
+		for (int32 Day = 0; Day < InNumDays; Day++)
+		{
+			const FTimeAlmanacDay Entry = ComputeDay(InFirstJulianDay + Day, Latitude);
+
+			FTimeAlmanacRecord Record;
+			Record.Sunrise = (uint16)FMath::Clamp(FMath::RoundToInt(Entry.SunriseMinutes * 30.0f), 0, 43199);
+			Record.Sunset = (uint16)FMath::Clamp(FMath::RoundToInt(Entry.SunsetMinutes * 30.0f), 0, 43199);
+			Record.MoonPhase = (uint8)(FMath::RoundToInt(Entry.MoonPhase * 256.0f) & 0xFF);
+			const int32 NorthernSeason = Latitude < 0.0f ? (Entry.Season + 2) % 4 : Entry.Season;
+			Record.Flags = (uint8)(NorthernSeason & ARF_SeasonMask)
+				| (Entry.bSeasonStart ? ARF_SeasonStart : 0)
+				| (Entry.bPolarNight ? ARF_PolarNight : 0)
+				| (Entry.bMidnightSun ? ARF_MidnightSun : 0);
+
+			*Ar << Record.Sunrise << Record.Sunset << Record.MoonPhase << Record.Flags;
+		}
+	}
+
+	return Ar->Close();
+}
+
+FString FTimeAlmanac::GetDefaultPath()
+{
+	return FPaths::ProjectContentDir() / TEXT("TimePlugin") / TEXT("TimeAlmanac.bin");
+}
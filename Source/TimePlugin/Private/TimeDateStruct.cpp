@@ -0,0 +1,47 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#include "TimeDateStruct.h"
+
+// This file must be present for FTimeDateStruct & FLocation
+
+bool FTimeDate::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 bPacked = 0;
+	int64 Ticks = 0;
+
+	if (Ar.IsSaving())
+	{
+		bPacked = FDateTime::Validate(Year, Month, Day, Hour, Minute, Second, Millisecond) ? 1 : 0;
+		if (bPacked)
+		{
+			Ticks = FDateTime(Year, Month, Day, Hour, Minute, Second, Millisecond).GetTicks();
+		}
+	}
+
+	Ar.SerializeBits(&bPacked, 1);
+
+	if (bPacked)
+	{
+		Ar << Ticks;
+
+		if (Ar.IsLoading())
+		{
+			const FDateTime DateTime(Ticks);
+			Year = DateTime.GetYear();
+			Month = DateTime.GetMonth();
+			Day = DateTime.GetDay();
+			Hour = DateTime.GetHour();
+			Minute = DateTime.GetMinute();
+			Second = DateTime.GetSecond();
+			Millisecond = DateTime.GetMillisecond();
+		}
+	}
+	else
+	{
+		Ar << Year << Month << Day << Hour << Minute << Second << Millisecond;
+	}
+
+	bOutSuccess = true;
+	return true;
+}
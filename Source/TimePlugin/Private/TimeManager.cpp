@@ -0,0 +1,570 @@
+#include "TimeManager.h"
+#include "TimePlugin.h"
+
+// Version of the save game clock block, written as its first byte
+enum EClockStateVersion : uint8
+{
+	// Saves from before the clock block existed
+	CSV_None = 0,
+	// Packed flags, InternalTime ticks and the clock settings
+	CSV_CompactClockState = 1,
+	CSV_Latest = CSV_CompactClockState
+};
+
+// Bits of the packed flags byte in the save game clock block
+enum EClockStateFlags : uint8
+{
+	CSF_UseSystemTime = 1 << 0,
+	CSF_AutoTick = 1 << 1,
+	CSF_FreezeTime = 1 << 2,
+	CSF_AllowDaylightSavings = 1 << 3,
+	CSF_CalendarInitialized = 1 << 4,
+};
+
+ATimeManager::ATimeManager(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	UpdateScheduler = PCIP.CreateDefaultSubobject<UTimeUpdateScheduler>(this, TEXT("UpdateScheduler"));
+}
+
+void ATimeManager::OnConstruction(const FTransform& Transform)
+{
+	ValidateTimeDate(CurrentLocalTime);
+	OnTimeChanged.Broadcast(CurrentLocalTime);
+}
+
+void ATimeManager::BeginPlay()
+{
+	Super::BeginPlay();
+	if (bUseSystemTime)
+	{
+		int32 Year, Month, Day, DayOfWeek;
+		int32 Hour, Minute, Second, Millisecond;
+
+		FPlatformTime::SystemTime(Year, Month, DayOfWeek, Day, Hour, Minute, Second, Millisecond);
+		FTimeDate SystemTime = FTimeDate(Year, Month, Day, Hour, Minute, Second, Millisecond);
+
+		InitializeTime(SystemTime);
+	}
+	else if (!bRestoredFromSave)
+	{
+		InitializeTime(CurrentLocalTime);
+	}
+	//Otherwise the clock was restored from a save game and is already fully set up
+}
+
+void ATimeManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	if (bAutoTick)
+	{
+		IncrementTime(DeltaTime);
+	}
+}
+
+void ATimeManager::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	//None of our properties are SaveGame flagged, so save games get the clock as one compact block instead
+	//The block carries its own version, save game archives usually don't keep custom versions
+	if (Ar.IsSaveGame())
+	{
+		SerializeClockState(Ar);
+	}
+}
+
+void ATimeManager::SerializeClockState(FArchive& Ar)
+{
+	uint8 BlockVersion = Ar.IsSaving() ? CSV_Latest : CSV_None;
+	Ar << BlockVersion;
+
+	//Saves from before the clock block end here, the read runs past the end and leaves the clock alone
+	if (Ar.IsError())
+	{
+		return;
+	}
+
+	if (BlockVersion < CSV_CompactClockState || BlockVersion > CSV_Latest)
+	{
+		UE_LOG(LogTimePlugin, Warning, TEXT("%s:: Unknown clock state version %d, keeping the current clock"), *PLUGIN_FUNC_LINE, BlockVersion);
+		Ar.SetError();
+		return;
+	}
+
+	uint8 Flags = 0;
+	int64 Ticks = 0;
+	int8 PackedOffsetUTC = 0;
+	float PackedLatitude = Latitude;
+	float PackedLongitude = Longitude;
+	float PackedTimeScale = TimeScaleMultiplier;
+
+	if (Ar.IsSaving())
+	{
+		Flags |= bUseSystemTime ? CSF_UseSystemTime : 0;
+		Flags |= bAutoTick ? CSF_AutoTick : 0;
+		Flags |= bFreezeTime ? CSF_FreezeTime : 0;
+		Flags |= bAllowDaylightSavings ? CSF_AllowDaylightSavings : 0;
+		Flags |= bIsCalendarInitialized ? CSF_CalendarInitialized : 0;
+
+		Ticks = bIsCalendarInitialized ? InternalTime.GetTicks() : ConvertToDateTime(ValidateTimeDate(CurrentLocalTime)).GetTicks();
+		PackedOffsetUTC = (int8)FMath::Clamp(OffsetUTC, -12, 12);
+	}
+
+	Ar << Flags;
+	Ar << Ticks;
+	Ar << PackedLatitude;
+	Ar << PackedLongitude;
+	Ar << PackedTimeScale;
+	Ar << PackedOffsetUTC;
+
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || Ticks < 0 || Ticks > FDateTime::MaxValue().GetTicks())
+		{
+			UE_LOG(LogTimePlugin, Warning, TEXT("%s:: Clock state is truncated or invalid, keeping the current clock"), *PLUGIN_FUNC_LINE);
+			Ar.SetError();
+			return;
+		}
+
+		bUseSystemTime = (Flags & CSF_UseSystemTime) != 0;
+		bAutoTick = (Flags & CSF_AutoTick) != 0;
+		bFreezeTime = (Flags & CSF_FreezeTime) != 0;
+		bAllowDaylightSavings = (Flags & CSF_AllowDaylightSavings) != 0;
+		OffsetUTC = PackedOffsetUTC;
+		Latitude = PackedLatitude;
+		Longitude = PackedLongitude;
+		TimeScaleMultiplier = PackedTimeScale;
+
+		//Restore the derived state directly, InitializeTime would broadcast to every listener
+		InternalTime = FDateTime(Ticks);
+		CurrentLocalTime = ConvertToTimeDate(InternalTime);
+		UpdateCalendarState();
+		bIsCalendarInitialized = (Flags & CSF_CalendarInitialized) != 0;
+		bRestoredFromSave = bIsCalendarInitialized;
+	}
+}
+
+
+void ATimeManager::InitializeTime(FTimeDate time)
+{
+	time = ValidateTimeDate(time);
+
+	InternalTime = ConvertToDateTime(time);
+	UpdateCalendarState();
+
+	CurrentLocalTime = time;
+	bIsCalendarInitialized = true;
+	OnTimeChanged.Broadcast(time); // Added delegate call 
+	BP_TimeChanged();
+}
+
+void ATimeManager::UpdateCalendarState()
+{
+	OffsetUTC = FMath::Clamp(OffsetUTC, -12, 12);
+
+	DayOfYear = InternalTime.GetDayOfYear();
+	bDaylightSavingsActive = IsDaylightSavingsDate(InternalTime);
+
+	OffsetDST = bAllowDaylightSavings && bDaylightSavingsActive ? 1 : 0;
+
+	// Local Standard Time Meridian (degrees) = 15 * Hour Offset from UTC
+	// The value of the local Standard Time Meridian (15deg intervals)
+	//NOT USED
+	LSTM = 15 * OffsetUTC;
+
+	SpanUTC = FTimespan((FMath::Abs(OffsetUTC) + OffsetDST), 0, 0);
+
+	Latitude = FMath::Clamp(Latitude, -90.0f, 90.0f);
+	Longitude = FMath::Clamp(Longitude, -180.0f, 180.0f);
+}
+
+FTimeDate ATimeManager::ValidateTimeDate(FTimeDate time)
+{
+	time.Year = FMath::Clamp<int32>(time.Year, 1, 9999);
+	time.Month = FMath::Clamp<int32>(time.Month, 1, 12);
+	time.Day = FMath::Clamp<int32>(time.Day, 1, GetDaysInMonth(time.Year, time.Month));
+	time.Hour = FMath::Clamp<int32>(time.Hour, 0, 23);
+	time.Minute = FMath::Clamp<int32>(time.Minute, 0, 59);
+	time.Second = FMath::Clamp<int32>(time.Second, 0, 59);
+	time.Millisecond = FMath::Clamp<int32>(time.Millisecond, 0, 999);
+
+	return time;
+}
+
+FTimeDate ATimeManager::ConvertToTimeDate(FDateTime dt)
+{
+	return FTimeDate(dt.GetYear(), dt.GetMonth(), dt.GetDay(), dt.GetHour(), dt.GetMinute(), dt.GetSecond(), dt.GetMillisecond());
+}
+
+FDateTime ATimeManager::ConvertToDateTime(FTimeDate td)
+{
+	if (FDateTime::Validate(td.Year, td.Month, td.Day, td.Hour, td.Minute, td.Second, td.Millisecond)) {
+		return FDateTime(td.Year, td.Month, td.Day, td.Hour, td.Minute, td.Second, td.Millisecond);
+	}
+	else 
+	{
+		UE_LOG(LogTimePlugin, Warning, TEXT("TimePlugin ConvertToDateTime: Invalid TimeData, quietly failing to (1,1,1,0,0,0,0)"));
+		return FDateTime(1, 1, 1, 0, 0, 0, 0);
+	}
+}
+
+
+/* --- Time of Day --- */
+
+float ATimeManager::GetElapsedDayInMinutes()
+{
+	if (!bIsCalendarInitialized)
+	{
+		return 0.0f;
+	}
+
+	return (float)InternalTime.GetTimeOfDay().GetTotalMinutes();
+}
+
+
+void ATimeManager::IncrementTime(float deltaTime)
+{
+	if (!bIsCalendarInitialized)
+	{
+		return;
+	}
+
+	const float GameDeltaSeconds = deltaTime * TimeScaleMultiplier;
+	InternalTime += FTimespan::FromSeconds(GameDeltaSeconds);
+
+	if (CurrentLocalTime.Day != InternalTime.GetDay())
+	{
+		int32 leapDays = IsLeapYear(InternalTime.GetYear());
+		DayOfYear = InternalTime.GetDayOfYear();
+
+		if (DayOfYear >= (79 + leapDays) && DayOfYear < (265 + leapDays))
+		{
+			bDaylightSavingsActive = true;
+		}
+	}
+	CurrentLocalTime = ConvertToTimeDate(InternalTime);
+
+	OnTimeChanged.Broadcast(CurrentLocalTime);
+	BP_TimeChanged();
+
+	if (UpdateScheduler)
+	{
+		UpdateScheduler->Advance(GameDeltaSeconds, CurrentLocalTime);
+	}
+}
+
+
+void ATimeManager::SetCurrentLocalTime(float time)
+{
+	float minute = FMath::Frac(time / 60) * 60;
+	float second = FMath::Frac(minute) * 60;
+	float millisec = FMath::Frac(second) * 1000;
+	FTimeDate newTD = FTimeDate(InternalTime.GetYear(), InternalTime.GetMonth(), InternalTime.GetDay(),
+		FPlatformMath::FloorToInt(time / 60), minute, second, millisec);
+
+	InitializeTime(newTD);
+}
+
+
+int32 ATimeManager::GetDaysInYear(int32 year)
+{
+	return FDateTime::DaysInYear(year);
+}
+
+
+int32 ATimeManager::GetDaysInMonth(int32 year, int32 month)
+{
+	return FDateTime::DaysInMonth(year, month);
+}
+
+
+int32 ATimeManager::GetDayOfYear(FTimeDate time)
+{
+	return ConvertToDateTime(time).GetDayOfYear();
+}
+
+
+float ATimeManager::GetDayPhase()
+{
+	if (!bIsCalendarInitialized)
+	{
+		return 0.0f;
+	}
+
+	return GetElapsedDayInMinutes() / 1440.0;
+}
+
+
+float ATimeManager::GetYearPhase()
+{
+	if (!bIsCalendarInitialized)
+	{
+		return 0.0f;
+	}
+
+	return InternalTime.DaysInYear(InternalTime.GetYear()) / (InternalTime.GetDayOfYear() + (GetElapsedDayInMinutes() / 1440));
+}
+
+
+bool ATimeManager::IsDaylightSavingsDate(const FDateTime& Date)
+{
+	const int32 Day = Date.GetDayOfYear();
+	const int32 leapDays = IsLeapYear(Date.GetYear());
+
+	return Day >= (79 + leapDays) && Day < (265 + leapDays);
+}
+
+
+bool ATimeManager::IsLeapYear(int32 year)
+{
+	bool isLeap = false;
+
+	if ((year % 4) == 0)
+	{
+		isLeap = (year % 100) == 0 ? (year % 400) == 0 : true;
+	}
+	return isLeap;
+}
+
+
+FTimeAlmanacDay ATimeManager::GetAlmanacDay(FTimeDate time)
+{
+	// The Julian Day Number is the Julian date at noon, midnight is .5 before it
+	const FDateTime Date = ConvertToDateTime(ValidateTimeDate(time)).GetDate();
+	const int32 JulianDayNumber = (int32)(Date.GetJulianDay() + 0.5);
+	FTimeAlmanacDay Day = FTimePlugin::Get().GetAlmanac().GetDay(JulianDayNumber, Latitude);
+
+	if (!Day.bPolarNight && !Day.bMidnightSun)
+	{
+		// DST of the date being looked up, not of the clock's current date
+		const int32 DateOffsetDST = bAllowDaylightSavings && IsDaylightSavingsDate(Date) ? 1 : 0;
+
+		// Almanac times are mean solar time at longitude 0, the sun is 4 minutes earlier per degree east, then add the time zone
+		const float OffsetMinutes = -4.0f * Longitude + 60.0f * (OffsetUTC + DateOffsetDST);
+		Day.SunriseMinutes = FMath::Fmod(Day.SunriseMinutes + OffsetMinutes + 2880.0f, 1440.0f);
+		Day.SunsetMinutes = FMath::Fmod(Day.SunsetMinutes + OffsetMinutes + 2880.0f, 1440.0f);
+	}
+	return Day;
+}
+
+
+/* --- Calendar Ranges --- */
+
+// Days since 0001-01-01, which was a Monday, so DayNumber % 7 is the FDateTime day of week
+static int64 GetDayNumber(const FDateTime& dt)
+{
+	return dt.GetTicks() / ETimespan::TicksPerDay;
+}
+
+// Adds whole days without overflowing the tick math, results outside FDateTime::MinValue/MaxValue are clamped to them
+static FDateTime AddWholeDays(const FDateTime& dt, int64 Days)
+{
+	const int64 MaxDays = (FDateTime::MaxValue().GetTicks() - dt.GetTicks()) / ETimespan::TicksPerDay;
+	const int64 MinDays = (FDateTime::MinValue().GetTicks() - dt.GetTicks()) / ETimespan::TicksPerDay;
+	if (Days > MaxDays)
+	{
+		return FDateTime::MaxValue();
+	}
+	if (Days < MinDays)
+	{
+		return FDateTime::MinValue();
+	}
+	return dt + FTimespan(Days * ETimespan::TicksPerDay);
+}
+
+TArray<FTimeDate> ATimeManager::GetCalendarBoundaries(FTimeDate start, FTimeDate end, ECalendarStep step)
+{
+	FCalendarRange Range(ConvertToDateTime(ValidateTimeDate(start)), ConvertToDateTime(ValidateTimeDate(end)), step);
+
+	TArray<FTimeDate> Boundaries;
+	Boundaries.Reserve(Range.Num());
+	for (const FDateTime& Boundary : Range)
+	{
+		Boundaries.Add(ConvertToTimeDate(Boundary));
+	}
+	return Boundaries;
+}
+
+
+int32 ATimeManager::CountCalendarBoundaries(FTimeDate start, FTimeDate end, ECalendarStep step)
+{
+	return FCalendarRange(ConvertToDateTime(ValidateTimeDate(start)), ConvertToDateTime(ValidateTimeDate(end)), step).Num();
+}
+
+
+int32 ATimeManager::CountWeekdaysBetween(FTimeDate start, FTimeDate end, int32 dayOfWeek)
+{
+	const int64 StartDay = GetDayNumber(ConvertToDateTime(ValidateTimeDate(start)));
+	const int64 EndDay = GetDayNumber(ConvertToDateTime(ValidateTimeDate(end)));
+	if (EndDay <= StartDay)
+	{
+		return 0;
+	}
+
+	const int64 Days = EndDay - StartDay;
+	const int64 DaysToFirstMatch = (FMath::Clamp(dayOfWeek, 0, 6) - StartDay % 7 + 7) % 7;
+
+	return (int32)(Days / 7 + (DaysToFirstMatch < Days % 7 ? 1 : 0));
+}
+
+
+int32 ATimeManager::CountBusinessDaysBetween(FTimeDate start, FTimeDate end)
+{
+	const int64 StartDay = GetDayNumber(ConvertToDateTime(ValidateTimeDate(start)));
+	const int64 EndDay = GetDayNumber(ConvertToDateTime(ValidateTimeDate(end)));
+	if (EndDay <= StartDay)
+	{
+		return 0;
+	}
+
+	const int64 Days = EndDay - StartDay;
+	int64 BusinessDays = (Days / 7) * 5;
+
+	//At most 6 leftover days after the full weeks
+	for (int64 Day = StartDay + (Days / 7) * 7; Day < EndDay; ++Day)
+	{
+		if (Day % 7 < 5)
+		{
+			BusinessDays++;
+		}
+	}
+	return (int32)BusinessDays;
+}
+
+
+FTimeDate ATimeManager::AddBusinessDays(FTimeDate time, int32 days)
+{
+	const FDateTime From = ConvertToDateTime(ValidateTimeDate(time));
+	if (days <= 0)
+	{
+		return ConvertToTimeDate(From);
+	}
+
+	int64 Day = GetDayNumber(From);
+	int64 DayOfWeek = Day % 7;
+
+	//Stepping from a weekend is the same as stepping from the Friday before it
+	if (DayOfWeek > 4)
+	{
+		Day -= DayOfWeek - 4;
+		DayOfWeek = 4;
+	}
+
+	Day += (int64)(days / 5) * 7;
+	const int32 Remainder = days % 5;
+	Day += DayOfWeek + Remainder > 4 ? Remainder + 2 : Remainder;
+
+	return ConvertToTimeDate(AddWholeDays(From, Day - GetDayNumber(From)));
+}
+
+
+FTimeDate ATimeManager::GetNextWeekday(FTimeDate time, int32 dayOfWeek, int32 n)
+{
+	const FDateTime From = ConvertToDateTime(ValidateTimeDate(time)).GetDate();
+	const int64 DaysToNext = (FMath::Clamp(dayOfWeek, 0, 6) - (int32)From.GetDayOfWeek() + 6) % 7 + 1;
+	const int64 Days = DaysToNext + 7 * (int64)(FMath::Max(n, 1) - 1);
+
+	return ConvertToTimeDate(AddWholeDays(From, Days));
+}
+
+
+FTimeDate ATimeManager::GetNthWeekdayOfMonth(int32 year, int32 month, int32 dayOfWeek, int32 n)
+{
+	year = FMath::Clamp<int32>(year, 1, 9999);
+	month = FMath::Clamp<int32>(month, 1, 12);
+	dayOfWeek = FMath::Clamp(dayOfWeek, 0, 6);
+	n = FMath::Clamp(n, -5, 5);
+
+	const int32 LastDay = GetDaysInMonth(year, month);
+	int32 Day;
+
+	if (n >= 0)
+	{
+		const int32 FirstDayOfWeek = (int32)FDateTime(year, month, 1).GetDayOfWeek();
+		Day = 1 + (dayOfWeek - FirstDayOfWeek + 7) % 7 + 7 * (FMath::Max(n, 1) - 1);
+	}
+	else
+	{
+		const int32 LastDayOfWeek = (int32)FDateTime(year, month, LastDay).GetDayOfWeek();
+		Day = LastDay - (LastDayOfWeek - dayOfWeek + 7) % 7 - 7 * (-n - 1);
+	}
+
+	//Only 4 or 5 of each weekday exist in a month
+	while (Day > LastDay)
+	{
+		Day -= 7;
+	}
+	while (Day < 1)
+	{
+		Day += 7;
+	}
+
+	return FTimeDate(year, month, Day, 0, 0, 0, 0);
+}
+
+//double  ATimeManager::toJulianDay(int year, int month, int day, int h, int m, int s) {
+//	// The conversion formulas are from Meeus, chapter 7.
+//	bool julian = false; // Use Gregorian calendar
+//	if (year < 1582 || (year == 1582 && month <= 10) || (year == 1582 && month == 10 && day < 15)) julian = true;
+//	int D = day;
+//	int M = month;
+//	int Y = year;
+//	if (M < 3) {
+//		Y--;
+//		M += 12;
+//	}
+//	int A = Y / 100;
+//	int B = julian ? 0 : 2 - A + A / 4;
+//
+//	double dayFraction = (h + (m + (s / 60.0)) / 60.0) / 24.0;
+//	double jd = dayFraction + (int)(365.25 * (Y + 4716)) + (int)(30.6001 * (M + 1)) + D + B - 1524.5;
+//
+//	if (jd < 2299160.0 && jd >= 2299150.0)
+//		//need to make this better somehow
+//		return 0.0;
+//
+//	return jd;
+//}
+
+
+
+
+/**
+ * Transforms a Julian day (rise/set/transit fields) to a common date.
+ * @param jd The Julian day.
+ * @return A set of integers: year, month, day, hour, minute, second.
+ * @throws Exception If the input date does not exists.
+ */
+TArray<int32>  ATimeManager::getDate(double jd) {
+	if (jd < 2299160.0 && jd >= 2299150.0)
+		//throw new Exception("invalid julian day " + jd + ". This date does not exist.");
+		return TArray<int32>{0};
+	// The conversion formulas are from Meeus,
+	// Chapter 7.
+	double Z = FMath::FloorToFloat(jd + 0.5);
+	double F = jd + 0.5 - Z;
+	double A = Z;
+	if (Z >= 2299161.0) {
+		int a = (int)((Z - 1867216.25) / 36524.25);
+		A += 1 + a - a / 4;
+	}
+	double B = A + 1524;
+	int C = (int)((B - 122.1) / 365.25);
+	int D = (int)(C * 365.25);
+	int E = (int)((B - D) / 30.6001);
+
+	double exactDay = F + B - D - (int)(30.6001 * E);
+	int day = (int)exactDay;
+	int month = (E < 14) ? E - 1 : E - 13;
+	int year = C - 4715;
+	if (month > 2) year--;
+	double h = ((exactDay - day) * SECONDS_PER_DAY) / 3600.0;
+
+	int hour = (int)h;
+	double m = (h - hour) * 60.0;
+	int minute = (int)m;
+	int second = (int)((m - minute) * 60.0);
+
+	return TArray<int32> {year, month, day, hour, minute, second};
+}
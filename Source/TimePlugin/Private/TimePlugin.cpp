@@ -15,6 +15,9 @@ void FTimePlugin::StartupModule()
 	//Auto create our TimeManager
 	//This is called everytime UWorld is created, which is a lot in the editor (every opened BP gets a UWorld)
 	FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FTimePlugin::InitSingletonActor);
+
+	//Map the precomputed almanac if the project has one, otherwise astronomy is computed live
+	Almanac.Open(FTimeAlmanac::GetDefaultPath());
 	UE_LOG(LogTimePlugin, Display, TEXT("%s:: Module started"), *PLUGIN_FUNC_LINE);
 }
 
@@ -23,6 +26,7 @@ void FTimePlugin::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
+	Almanac.Close();
 }
 
 void FTimePlugin::EnforceSingletonActor(UWorld* World)
@@ -0,0 +1,278 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#include "TimeUpdateScheduler.h"
+
+int32 UTimeUpdateScheduler::RegisterUpdate(FOnScheduledTimeUpdate Callback, float PeriodMinutes)
+{
+	if (!Callback.IsBound())
+	{
+		return 0;
+	}
+
+	FTimeUpdateRegistration Registration;
+	Registration.Handle = NextHandle++;
+	Registration.Callback = Callback;
+	Registration.LastGameSeconds = GameSeconds;
+
+	const double PeriodSeconds = FMath::Max(PeriodMinutes * 60.0, 1.0);
+
+	if (bIsUpdating)
+	{
+		PendingRegistrations.Add(TPair<FTimeUpdateRegistration, double>(Registration, PeriodSeconds));
+	}
+	else
+	{
+		AddRegistration(Registration, PeriodSeconds);
+	}
+	return Registration.Handle;
+}
+
+void UTimeUpdateScheduler::AddRegistration(const FTimeUpdateRegistration& Registration, double PeriodSeconds)
+{
+	for (FTimeUpdateBucket& Bucket : Buckets)
+	{
+		if (FMath::IsNearlyEqual(Bucket.PeriodSeconds, PeriodSeconds, 0.001))
+		{
+			//Joining mid-cycle would make part of the bucket due at once, wait for the next cycle instead
+			if (Bucket.Entries.Num() > 0)
+			{
+				Bucket.Pending.Add(Registration);
+			}
+			else
+			{
+				Bucket.Entries.Add(Registration);
+			}
+			return;
+		}
+	}
+
+	FTimeUpdateBucket& Bucket = Buckets[Buckets.AddDefaulted()];
+	Bucket.PeriodSeconds = PeriodSeconds;
+	Bucket.Entries.Add(Registration);
+}
+
+void UTimeUpdateScheduler::UnregisterUpdate(int32 Handle)
+{
+	UnbindRegistrations([Handle](const FTimeUpdateRegistration& Registration)
+	{
+		return Registration.Handle == Handle;
+	});
+}
+
+void UTimeUpdateScheduler::UnregisterObject(UObject* Object)
+{
+	UnbindRegistrations([Object](const FTimeUpdateRegistration& Registration)
+	{
+		return Registration.Callback.GetUObject() == Object;
+	});
+}
+
+void UTimeUpdateScheduler::UnbindRegistrations(TFunctionRef<bool(const FTimeUpdateRegistration&)> Predicate)
+{
+	//Only unbind here, removing entries mid-cycle would shift the timing of the rest of the bucket
+	for (FTimeUpdateBucket& Bucket : Buckets)
+	{
+		for (FTimeUpdateRegistration& Registration : Bucket.Entries)
+		{
+			if (Predicate(Registration))
+			{
+				Registration.Callback.Unbind();
+				Bucket.bHasUnbound = true;
+			}
+		}
+
+		for (FTimeUpdateRegistration& Registration : Bucket.Pending)
+		{
+			if (Predicate(Registration))
+			{
+				Registration.Callback.Unbind();
+			}
+		}
+	}
+
+	for (TPair<FTimeUpdateRegistration, double>& Pending : PendingRegistrations)
+	{
+		if (Predicate(Pending.Key))
+		{
+			Pending.Key.Callback.Unbind();
+		}
+	}
+}
+
+void UTimeUpdateScheduler::UpdateAll(FTimeDate CurrentTime)
+{
+	if (bIsUpdating)
+	{
+		return;
+	}
+
+	bIsUpdating = true;
+	for (FTimeUpdateBucket& Bucket : Buckets)
+	{
+		for (FTimeUpdateRegistration& Registration : Bucket.Entries)
+		{
+			if (!CallRegistration(Registration, CurrentTime))
+			{
+				Bucket.bHasUnbound = true;
+			}
+		}
+
+		for (FTimeUpdateRegistration& Registration : Bucket.Pending)
+		{
+			CallRegistration(Registration, CurrentTime);
+		}
+	}
+	bIsUpdating = false;
+}
+
+void UTimeUpdateScheduler::Advance(float GameDeltaSeconds, const FTimeDate& CurrentTime)
+{
+	if (bIsUpdating || GameDeltaSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	GameSeconds += GameDeltaSeconds;
+	bIsUpdating = true;
+
+	for (FTimeUpdateBucket& Bucket : Buckets)
+	{
+		if (Bucket.Entries.Num() == 0)
+		{
+			continue;
+		}
+
+		Bucket.Progress += GameDeltaSeconds / Bucket.PeriodSeconds;
+
+		//Each entry is called at most once per frame
+		int32 CallsLeft = Bucket.Entries.Num();
+
+		while (Bucket.Entries.Num() > 0)
+		{
+			//Entry i is due at i / NumEntries of the period, so the bucket's calls are spread evenly across frames
+			const int32 NumEntries = Bucket.Entries.Num();
+			const int32 DueIndex = (int32)FMath::Min(FMath::FloorToDouble(Bucket.Progress * NumEntries), (double)NumEntries);
+
+			while (Bucket.Cursor < DueIndex && CallsLeft > 0)
+			{
+				if (!CallRegistration(Bucket.Entries[Bucket.Cursor], CurrentTime))
+				{
+					Bucket.bHasUnbound = true;
+				}
+				Bucket.Cursor++;
+				CallsLeft--;
+			}
+
+			if (Bucket.Cursor < NumEntries)
+			{
+				break;
+			}
+
+			Bucket.Cursor = 0;
+			Bucket.Progress = FMath::Max(Bucket.Progress - 1.0, 0.0);
+			StartNextCycle(Bucket);
+
+			if (CallsLeft <= 0)
+			{
+				break;
+			}
+		}
+
+		if (CallsLeft <= 0 && Bucket.Entries.Num() > 0 && Bucket.Progress > 1.0)
+		{
+			//More than a whole period passed in one frame (huge TimeScaleMultiplier), everyone was called once, drop the backlog
+			Bucket.Progress = (double)Bucket.Cursor / Bucket.Entries.Num();
+		}
+	}
+
+	bIsUpdating = false;
+
+	for (const TPair<FTimeUpdateRegistration, double>& Pending : PendingRegistrations)
+	{
+		if (Pending.Key.Callback.IsBound())
+		{
+			AddRegistration(Pending.Key, Pending.Value);
+		}
+	}
+	PendingRegistrations.Reset();
+
+	if (bHasEmptyBuckets)
+	{
+		RemoveEmptyBuckets();
+	}
+}
+
+bool UTimeUpdateScheduler::CallRegistration(FTimeUpdateRegistration& Registration, const FTimeDate& CurrentTime)
+{
+	//IsBound is false once the bound object is destroyed or the registration was removed
+	if (!Registration.Callback.IsBound())
+	{
+		return false;
+	}
+
+	const float ElapsedGameSeconds = (float)(GameSeconds - Registration.LastGameSeconds);
+	Registration.LastGameSeconds = GameSeconds;
+	Registration.Callback.Execute(CurrentTime, ElapsedGameSeconds);
+	return true;
+}
+
+void UTimeUpdateScheduler::StartNextCycle(FTimeUpdateBucket& Bucket)
+{
+	if (Bucket.bHasUnbound)
+	{
+		Bucket.Entries.RemoveAll([](const FTimeUpdateRegistration& Registration)
+		{
+			return !Registration.Callback.IsBound();
+		});
+		Bucket.bHasUnbound = false;
+	}
+
+	for (const FTimeUpdateRegistration& Registration : Bucket.Pending)
+	{
+		if (Registration.Callback.IsBound())
+		{
+			Bucket.Entries.Add(Registration);
+		}
+	}
+	Bucket.Pending.Reset();
+
+	if (Bucket.Entries.Num() == 0)
+	{
+		Bucket.Progress = 0.0;
+		bHasEmptyBuckets = true;
+	}
+}
+
+void UTimeUpdateScheduler::RemoveEmptyBuckets()
+{
+	for (int32 BucketIndex = Buckets.Num() - 1; BucketIndex >= 0; BucketIndex--)
+	{
+		if (Buckets[BucketIndex].Entries.Num() == 0 && Buckets[BucketIndex].Pending.Num() == 0)
+		{
+			Buckets.RemoveAtSwap(BucketIndex);
+		}
+	}
+	bHasEmptyBuckets = false;
+}
+
+int32 UTimeUpdateScheduler::GetNumRegistrations() const
+{
+	int32 NumRegistrations = 0;
+	for (const FTimeUpdateBucket& Bucket : Buckets)
+	{
+		for (const FTimeUpdateRegistration& Registration : Bucket.Entries)
+		{
+			NumRegistrations += Registration.Callback.IsBound() ? 1 : 0;
+		}
+		for (const FTimeUpdateRegistration& Registration : Bucket.Pending)
+		{
+			NumRegistrations += Registration.Callback.IsBound() ? 1 : 0;
+		}
+	}
+	for (const TPair<FTimeUpdateRegistration, double>& Pending : PendingRegistrations)
+	{
+		NumRegistrations += Pending.Key.Callback.IsBound() ? 1 : 0;
+	}
+	return NumRegistrations;
+}
@@ -0,0 +1,75 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#pragma once
+
+//#include "CoreMinimal.h"
+#include "Misc/DateTime.h"
+#include "CalendarRange.generated.h"
+
+
+// The calendar boundary a FCalendarRange steps over
+UENUM(BlueprintType)
+enum class ECalendarStep : uint8
+{
+	// Every midnight
+	Day,
+	// Every midnight that starts a week
+	Week,
+	// Every midnight that starts a month
+	Month
+};
+
+
+/**
+* A lazy range of day, week or month boundaries.
+* Boundaries are computed from their index when dereferenced, so nothing is allocated
+* and Num() is O(1) no matter how many days the range spans.
+*
+*	for (const FDateTime& MonthStart : FCalendarRange(Start, End, ECalendarStep::Month)) { ... }
+*/
+class TIMEPLUGIN_API FCalendarRange
+{
+public:
+	// All boundaries in [InStart, InEnd)
+	FCalendarRange(const FDateTime& InStart, const FDateTime& InEnd, ECalendarStep InStep, EDayOfWeek InWeekStart = EDayOfWeek::Monday);
+
+	// The first InCount boundaries at or after InStart (clamped to FDateTime::MaxValue)
+	FCalendarRange(const FDateTime& InStart, int32 InCount, ECalendarStep InStep, EDayOfWeek InWeekStart = EDayOfWeek::Monday);
+
+	// The number of boundaries in this range
+	int32 Num() const { return Count; }
+
+	// The boundary at the given index, valid for 0 to Num() - 1
+	FDateTime operator[](int32 Index) const;
+
+	class FIterator
+	{
+	public:
+		FIterator(const FCalendarRange& InRange, int32 InIndex) : Range(InRange), Index(InIndex) {}
+
+		FDateTime operator*() const { return Range[Index]; }
+		FIterator& operator++() { ++Index; return *this; }
+		bool operator!=(const FIterator& Other) const { return Index != Other.Index; }
+
+	private:
+		const FCalendarRange& Range;
+		int32 Index;
+	};
+
+	FIterator begin() const { return FIterator(*this, 0); }
+	FIterator end() const { return FIterator(*this, Count); }
+
+private:
+	// Finds the first boundary at or after InStart
+	void SetFirstBoundary(const FDateTime& InStart, EDayOfWeek InWeekStart);
+
+	// The number of boundaries between First and InEnd (exclusive)
+	int32 CountBoundariesBefore(const FDateTime& InEnd) const;
+
+	ECalendarStep Step;
+	FDateTime First;
+	// Year * 12 + (Month - 1) of First, only used for month steps
+	int32 FirstMonthIndex = 0;
+	int32 Count = 0;
+};
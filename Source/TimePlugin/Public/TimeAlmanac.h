@@ -0,0 +1,91 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#pragma once
+
+//#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "TimeAlmanac.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+
+// Sun, moon and season data for one date at one location
+USTRUCT(BlueprintType)
+struct FTimeAlmanacDay
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Minutes after midnight the sun rises (0 if it does not rise or set this day)
+	UPROPERTY(BlueprintReadOnly, Category = "Time")
+	float SunriseMinutes = 0.0f;
+
+	// Minutes after midnight the sun sets (0 if it does not rise or set this day)
+	UPROPERTY(BlueprintReadOnly, Category = "Time")
+	float SunsetMinutes = 0.0f;
+
+	// Moon phase in a 0.0 to 1.0 range (0 = new moon, 0.5 = full moon)
+	UPROPERTY(BlueprintReadOnly, Category = "Time")
+	float MoonPhase = 0.0f;
+
+	// Astronomical season for the hemisphere (0 = spring, 1 = summer, 2 = autumn, 3 = winter)
+	UPROPERTY(BlueprintReadOnly, Category = "Time")
+	int32 Season = 0;
+
+	// True when an equinox or solstice falls on this date
+	UPROPERTY(BlueprintReadOnly, Category = "Time")
+	bool bSeasonStart = false;
+
+	// True when the sun stays below the horizon all day
+	UPROPERTY(BlueprintReadOnly, Category = "Time")
+	bool bPolarNight = false;
+
+	// True when the sun stays above the horizon all day
+	UPROPERTY(BlueprintReadOnly, Category = "Time")
+	bool bMidnightSun = false;
+};
+
+
+/**
+* A precomputed table of FTimeAlmanacDay values per latitude band, read from a memory mapped file.
+* Sunrise and sunset are stored in mean solar time at longitude 0, so one band serves every longitude.
+* Lookups are O(1) by date, and any date or latitude outside the file is computed live instead.
+*
+* Build the file with the TimeAlmanac commandlet:
+*	UE4Editor-Cmd.exe MyProject -run=TimeAlmanac -StartYear=2000 -Years=100 -BandSize=1
+*/
+class TIMEPLUGIN_API FTimeAlmanac
+{
+public:
+	FTimeAlmanac();
+	~FTimeAlmanac();
+
+	// Maps an almanac file, returns false (and stays on live computation) if it is missing or invalid
+	bool Open(const FString& Path);
+	void Close();
+	bool IsOpen() const { return Records != nullptr; }
+
+	// Looks a date up in the mapped file, falling back to ComputeDay when it is not covered
+	FTimeAlmanacDay GetDay(int32 JulianDayNumber, float Latitude) const;
+
+	// Computes the almanac entry for a date (Julian Day Number at noon UTC) and latitude from scratch
+	static FTimeAlmanacDay ComputeDay(int32 JulianDayNumber, float Latitude);
+
+	// Generates an almanac file covering NumDays dates for NumBands latitude bands
+	static bool WriteFile(const FString& Path, int32 FirstJulianDay, int32 NumDays, float FirstLatitude, float BandSize, int32 NumBands);
+
+	// Where the plugin looks for the almanac on startup
+	static FString GetDefaultPath();
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const struct FTimeAlmanacRecord* Records = nullptr;
+	int32 FirstJulianDay = 0;
+	int32 NumDays = 0;
+	float FirstLatitude = 0.0f;
+	float BandSize = 0.0f;
+	int32 NumBands = 0;
+};
@@ -49,4 +49,16 @@ struct FTimeDate
 		Second = InSecond;
 		Millisecond = InMillisecond;
 	}
+
+	// Replicates this time and date as a single tick count when it is a valid date, otherwise as the raw fields
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FTimeDate> : public TStructOpsTypeTraitsBase2<FTimeDate>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
 };
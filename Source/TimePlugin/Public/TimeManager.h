@@ -3,6 +3,9 @@
 //#include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "TimeDateStruct.h"
+#include "CalendarRange.h"
+#include "TimeAlmanac.h"
+#include "TimeUpdateScheduler.h"
 #include "TimeManager.generated.h"
 
 
@@ -13,7 +16,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTimeChanged, FTimeDate, NewTime);
 //Transient will prevent this from being saved since we autospawn this anyways
 //Removed the Transient property, plugin will spawn this if its missing, and wont if its already there
 UCLASS(Blueprintable)
-class ATimeManager : public AActor
+class TIMEPLUGIN_API ATimeManager : public AActor
 {
 	GENERATED_BODY()
 
@@ -23,6 +26,7 @@ public:
 	virtual void OnConstruction(const FTransform& Transform) override;
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaSeconds) override;
+	virtual void Serialize(FArchive& Ar) override;
 
 	// Use System Time instead of CurrentLocalTime struct
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "TimeManager")
@@ -83,21 +87,25 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "TimeManager")
 		FOnTimeChanged OnTimeChanged;
 
+	/* Calls registered objects every N game minutes, spread across frames, so they don't need to tick */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "TimeManager")
+		UTimeUpdateScheduler* UpdateScheduler;
 
 
 
 
-	const double JULIAN_DAYS_PER_CENTURY = 36525.0;
+
+	static constexpr double JULIAN_DAYS_PER_CENTURY = 36525.0;
 	/** Julian century conversion constant = 100 * days per year. */
 	UPROPERTY(BlueprintReadOnly, Category = "TimeManager")
 		float F_JULIAN_DAYS_PER_CENTRY = JULIAN_DAYS_PER_CENTURY;
 
-	const double SECONDS_PER_DAY = 86400.0;
+	static constexpr double SECONDS_PER_DAY = 86400.0;
 	/** Seconds in one day. */
 	UPROPERTY(BlueprintReadOnly, Category = "TimeManager")
 		float F_SECONDS_PER_DAY = SECONDS_PER_DAY;
 
-	const double J2000 = 2451545.0;
+	static constexpr double J2000 = 2451545.0;
 	/** Our default epoch. The Julian Day which represents noon on 2000-01-01. */
 	UPROPERTY(BlueprintReadOnly, Category = "TimeManager")
 		float F_J2000 = J2000;
@@ -213,6 +221,104 @@ public:
 		bool IsLeapYear(int32 year = 1900);
 
 
+	/**
+	* Name: GetAlmanacDay
+	* Description: Gets sunrise, sunset, moon phase and season for a date at the current Latitude/Longitude.
+	*              Read from the precomputed almanac when it covers the date, computed live otherwise.
+	*
+	* @param: time (TimeDate) - The date to look up (the time of day is ignored).
+	* @return: FTimeAlmanacDay - Sunrise and sunset are in minutes after local midnight (OffsetUTC + DST of the looked up date).
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		FTimeAlmanacDay GetAlmanacDay(FTimeDate time);
+
+	/* --- Calendar Range Functions --- */
+	/* Day of week values follow FDateTime: 0 = Monday ... 6 = Sunday */
+
+	/**
+	* Name: GetCalendarBoundaries
+	* Description: Gets every day, week (Monday) or month start in the range [start, end). Use FCalendarRange from C++ to avoid the array.
+	*
+	* @param: start (TimeDate) - The start of the range (inclusive).
+	* @param: end (TimeDate) - The end of the range (exclusive).
+	* @param: step (ECalendarStep) - The boundary to step over.
+	* @return: TArray<FTimeDate> - The boundaries in ascending order.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		TArray<FTimeDate> GetCalendarBoundaries(FTimeDate start, FTimeDate end, ECalendarStep step);
+
+	/**
+	* Name: CountCalendarBoundaries
+	* Description: Counts the day, week (Monday) or month starts in the range [start, end) without visiting them.
+	*
+	* @param: start (TimeDate) - The start of the range (inclusive).
+	* @param: end (TimeDate) - The end of the range (exclusive).
+	* @param: step (ECalendarStep) - The boundary to count.
+	* @return: int32 - The number of boundaries in the range.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		int32 CountCalendarBoundaries(FTimeDate start, FTimeDate end, ECalendarStep step);
+
+	/**
+	* Name: CountWeekdaysBetween
+	* Description: Counts the dates falling on the given day of week, from the date of start up to (not including) the date of end.
+	*
+	* @param: start (TimeDate) - The first date to consider.
+	* @param: end (TimeDate) - The date to stop before.
+	* @param: dayOfWeek (int32) - The day of week to count (0 = Monday).
+	* @return: int32 - The number of matching dates, 0 if end is not after start.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		int32 CountWeekdaysBetween(FTimeDate start, FTimeDate end, int32 dayOfWeek = 0);
+
+	/**
+	* Name: CountBusinessDaysBetween
+	* Description: Counts the Monday to Friday dates from the date of start up to (not including) the date of end.
+	*
+	* @param: start (TimeDate) - The first date to consider.
+	* @param: end (TimeDate) - The date to stop before.
+	* @return: int32 - The number of business days, 0 if end is not after start.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		int32 CountBusinessDaysBetween(FTimeDate start, FTimeDate end);
+
+	/**
+	* Name: AddBusinessDays
+	* Description: Steps forward the given number of Monday to Friday dates, skipping weekends. The time of day is kept.
+	*
+	* @param: time (TimeDate) - The TimeDate to step from.
+	* @param: days (int32) - The number of business days to add (negative values are treated as 0, results past 9999-12-31 are clamped).
+	* @return: FTimeDate - The resulting TimeDate.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		FTimeDate AddBusinessDays(FTimeDate time, int32 days = 1);
+
+	/**
+	* Name: GetNextWeekday
+	* Description: Gets the nth date after the date of time that falls on the given day of week, at midnight.
+	*
+	* @param: time (TimeDate) - The TimeDate to search from (its own date is never returned).
+	* @param: dayOfWeek (int32) - The day of week to find (0 = Monday).
+	* @param: n (int32) - Which occurrence to return, 1 for the next one (results past 9999-12-31 are clamped).
+	* @return: FTimeDate - The matching date.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		FTimeDate GetNextWeekday(FTimeDate time, int32 dayOfWeek = 0, int32 n = 1);
+
+	/**
+	* Name: GetNthWeekdayOfMonth
+	* Description: Gets the nth given day of week in a month, e.g. the 2nd Tuesday, or the last Friday with n = -1.
+	*
+	* @param: year (int32) - The year value.
+	* @param: month (int32) - The month value.
+	* @param: dayOfWeek (int32) - The day of week to find (0 = Monday).
+	* @param: n (int32) - 1 to 5 counts from the start of the month, -1 to -5 from the end. Clamped to the occurrences that exist.
+	* @return: FTimeDate - The matching date at midnight.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		FTimeDate GetNthWeekdayOfMonth(int32 year = 1900, int32 month = 1, int32 dayOfWeek = 0, int32 n = 1);
+
+
 	//These would be normally be private, but plugins will need this stuff
 	//These are still private blueprint wise
 
@@ -244,6 +350,34 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "TimeManager")
 	bool bIsCalendarInitialized = false;
 
+	// Set when a save game restored an initialized clock, so BeginPlay keeps it instead of calling InitializeTime
+	UPROPERTY(Transient)
+	bool bRestoredFromSave = false;
+
+protected:
+
+	/**
+	* Name: IsDaylightSavingsDate
+	* Description: Determines whether the given date falls in the Daylight Savings period (ignores bAllowDaylightSavings).
+	*
+	* @param: Date (FDateTime) - The date to check.
+	* @return: bool - True if Daylight Savings applies to the date.
+	*/
+	bool IsDaylightSavingsDate(const FDateTime& Date);
+
+	/**
+	* Name: UpdateCalendarState
+	* Description: Recomputes the values derived from InternalTime and the location settings (DayOfYear, DST, SpanUTC, LSTM) without broadcasting.
+	*/
+	void UpdateCalendarState();
+
+	/**
+	* Name: SerializeClockState
+	* Description: Reads or writes the clock as one packed block: block version, flags, InternalTime ticks and the clock settings.
+	*
+	* @param: Ar (FArchive) - The save game archive to serialize with.
+	*/
+	void SerializeClockState(FArchive& Ar);
 
 
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "TimeManager.h"
+#include "TimeAlmanac.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTimePlugin, Display, All);
 
@@ -25,6 +26,9 @@ public:
 
 	ATimeManager * GetSingletonActor(UObject* WorldContextObject);
 
+	// The precomputed almanac shared by every world, falls back to live computation if no file was found
+	const FTimeAlmanac& GetAlmanac() const { return Almanac; }
+
 	/**
 	* Singleton-like access to this module's interface.  This is just for convenience!
 	* Beware of calling this during the shutdown phase, though.  Your module might have been unloaded already.
@@ -45,5 +49,8 @@ public:
 	{
 		return FModuleManager::Get().IsModuleLoaded("TimePlugin");
 	}
+
+private:
+	FTimeAlmanac Almanac;
 };
 
@@ -0,0 +1,143 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#pragma once
+
+//#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "TimeDateStruct.h"
+#include "TimeUpdateScheduler.generated.h"
+
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnScheduledTimeUpdate, FTimeDate, CurrentTime, float, ElapsedGameSeconds);
+
+
+struct FTimeUpdateRegistration
+{
+	int32 Handle = 0;
+
+	FOnScheduledTimeUpdate Callback;
+
+	// Scheduler game time of the last call, used to report the elapsed game time
+	double LastGameSeconds = 0.0;
+};
+
+
+// Every registration sharing one update period, called in order as the period progresses
+// Entries only changes when a cycle ends, so the period of each entry stays exact while registrations come and go
+struct FTimeUpdateBucket
+{
+	double PeriodSeconds = 0.0;
+
+	// Fraction of the period elapsed in the current cycle
+	double Progress = 0.0;
+
+	// Index of the next registration to call in the current cycle
+	int32 Cursor = 0;
+
+	TArray<FTimeUpdateRegistration> Entries;
+
+	// Registrations added during the current cycle, appended to Entries when it ends
+	TArray<FTimeUpdateRegistration> Pending;
+
+	// Set when an entry was unbound, Entries is compacted when the cycle ends
+	bool bHasUnbound = false;
+};
+
+
+/**
+* Calls registered objects at a fixed game time period (e.g. every 5 game minutes) instead of every frame.
+* Registrations with the same period share a bucket, and each bucket spreads its calls evenly over the
+* period, so every frame only calls the few entries that are due. The scheduler is advanced by
+* ATimeManager::IncrementTime with the scaled game time, so changing TimeScaleMultiplier changes how
+* many frames a period lasts, not how much game time it covers.
+*
+* A registration made mid-cycle joins its bucket when the current cycle ends, so its first call comes
+* within two periods. Registered actors can turn their own tick off. Time jumps through InitializeTime/SetCurrentLocalTime
+* are not seen as elapsed time, listen to OnTimeChanged or call UpdateAll for those.
+*/
+UCLASS(BlueprintType)
+class TIMEPLUGIN_API UTimeUpdateScheduler : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	* Name: RegisterUpdate
+	* Description: Calls the callback once every given number of game minutes.
+	*
+	* @param: Callback (FOnScheduledTimeUpdate) - The event to call with the current time and the game seconds since its last call.
+	* @param: PeriodMinutes (float) - The game time between calls in minutes (clamped to at least 1 game second).
+	* @return: int32 - A handle for UnregisterUpdate.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		int32 RegisterUpdate(FOnScheduledTimeUpdate Callback, float PeriodMinutes = 5.0f);
+
+	/**
+	* Name: UnregisterUpdate
+	* Description: Stops the updates for a handle returned by RegisterUpdate. Safe to call from inside an update.
+	*
+	* @param: Handle (int32) - The registration to remove.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		void UnregisterUpdate(int32 Handle);
+
+	/**
+	* Name: UnregisterObject
+	* Description: Stops every update bound to the given object, e.g. from EndPlay.
+	*
+	* @param: Object (UObject) - The object whose registrations should be removed.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		void UnregisterObject(UObject* Object);
+
+	/**
+	* Name: UpdateAll
+	* Description: Calls every registration right away, e.g. after jumping the clock to a new time.
+	*
+	* @param: CurrentTime (TimeDate) - The time to pass to the callbacks.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "TimeManager")
+		void UpdateAll(FTimeDate CurrentTime);
+
+	/**
+	* Name: Advance
+	* Description: Moves the scheduler forward and calls the registrations that came due, driven by ATimeManager.
+	*
+	* @param: GameDeltaSeconds (float) - The elapsed game time (already multiplied by TimeScaleMultiplier).
+	* @param: CurrentTime (TimeDate) - The time to pass to the callbacks.
+	*/
+	void Advance(float GameDeltaSeconds, const FTimeDate& CurrentTime);
+
+	// The number of active registrations
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "TimeManager")
+		int32 GetNumRegistrations() const;
+
+private:
+	void AddRegistration(const FTimeUpdateRegistration& Registration, double PeriodSeconds);
+
+	// Calls a registration, returns false (and leaves it alone) if its object is gone or it was unregistered
+	bool CallRegistration(FTimeUpdateRegistration& Registration, const FTimeDate& CurrentTime);
+
+	// Marks every registration matching the predicate unbound, the entries are dropped when their cycle ends
+	void UnbindRegistrations(TFunctionRef<bool(const FTimeUpdateRegistration&)> Predicate);
+
+	// Ends a bucket's cycle: drops unbound entries and appends the pending ones
+	void StartNextCycle(FTimeUpdateBucket& Bucket);
+
+	// Removes buckets left without any registrations
+	void RemoveEmptyBuckets();
+
+	TArray<FTimeUpdateBucket> Buckets;
+
+	// Registrations made during an update, added once it finishes
+	TArray<TPair<FTimeUpdateRegistration, double>> PendingRegistrations;
+
+	double GameSeconds = 0.0;
+	int32 NextHandle = 1;
+	bool bIsUpdating = false;
+
+	// Set when a bucket may have become empty, so buckets are only checked when something was removed
+	bool bHasEmptyBuckets = false;
+};
@@ -0,0 +1,56 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#include "TimeAlmanacCommandlet.h"
+#include "TimePluginEditor.h"
+#include "TimePlugin.h"
+#include "TimeAlmanac.h"
+#include "Misc/Parse.h"
+
+UTimeAlmanacCommandlet::UTimeAlmanacCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTimeAlmanacCommandlet::Main(const FString& Params)
+{
+	int32 StartYear = 2000;
+	int32 Years = 100;
+	float MinLatitude = -90.0f;
+	float MaxLatitude = 90.0f;
+	float BandSize = 1.0f;
+	FString Output = FTimeAlmanac::GetDefaultPath();
+
+	FParse::Value(*Params, TEXT("StartYear="), StartYear);
+	FParse::Value(*Params, TEXT("Years="), Years);
+	FParse::Value(*Params, TEXT("MinLatitude="), MinLatitude);
+	FParse::Value(*Params, TEXT("MaxLatitude="), MaxLatitude);
+	FParse::Value(*Params, TEXT("BandSize="), BandSize);
+	FParse::Value(*Params, TEXT("Output="), Output);
+
+	// The season series from Meeus only cover years up to 3000
+	StartYear = FMath::Clamp<int32>(StartYear, 1, 3000);
+	Years = FMath::Clamp<int32>(Years, 1, 3001 - StartYear);
+	MinLatitude = FMath::Clamp(MinLatitude, -90.0f, 90.0f);
+	MaxLatitude = FMath::Clamp(MaxLatitude, MinLatitude, 90.0f);
+	BandSize = FMath::Max(BandSize, 0.1f);
+
+	// Julian Day Numbers are the Julian date at noon, GetJulianDay gives the midnight value .5 before it
+	const int32 FirstJulianDay = (int32)(FDateTime(StartYear, 1, 1).GetDate().GetJulianDay() + 0.5);
+	const int32 LastJulianDay = (int32)(FDateTime(StartYear + Years - 1, 12, 31).GetDate().GetJulianDay() + 0.5);
+	const int32 NumBands = FMath::FloorToInt((MaxLatitude - MinLatitude) / BandSize) + 1;
+
+	UE_LOG(LogTimePluginEditor, Display, TEXT("%s:: Writing almanac for %d-%d, latitude %.1f to %.1f in %d bands to %s"),
+		*PLUGIN_FUNC_LINE, StartYear, StartYear + Years - 1, MinLatitude, MaxLatitude, NumBands, *Output);
+
+	if (!FTimeAlmanac::WriteFile(Output, FirstJulianDay, LastJulianDay - FirstJulianDay + 1, MinLatitude, BandSize, NumBands))
+	{
+		UE_LOG(LogTimePluginEditor, Error, TEXT("%s:: Failed to write almanac %s"), *PLUGIN_FUNC_LINE, *Output);
+		return 1;
+	}
+
+	return 0;
+}
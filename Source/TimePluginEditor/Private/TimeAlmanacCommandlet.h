@@ -0,0 +1,27 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "TimeAlmanacCommandlet.generated.h"
+
+/*
+*	Generates the precomputed almanac read by FTimeAlmanac.
+*
+*	UE4Editor-Cmd.exe MyProject -run=TimeAlmanac [-StartYear=2000] [-Years=100] [-MinLatitude=-90] [-MaxLatitude=90] [-BandSize=1] [-Output=Path]
+*
+*	Years are clamped to 1..3000, the range of the season formulas.
+*	Output defaults to FTimeAlmanac::GetDefaultPath(). The file is memory mapped at runtime, so stage it
+*	outside the pak (e.g. DirectoriesToAlwaysStageAsNonUFS) for packaged builds.
+*/
+UCLASS()
+class UTimeAlmanacCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTimeAlmanacCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,414 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#include "TimeBenchmarkCommandlet.h"
+#include "TimePluginEditor.h"
+#include "TimePlugin.h"
+#include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+// Simulated frame time, 60 fps
+static const float BENCHMARK_DELTA_SECONDS = 1.0f / 60.0f;
+
+template<typename T>
+static TArray<T> ParseList(const FString& Params, const TCHAR* Key, const TArray<T>& Default)
+{
+	FString Value;
+	if (!FParse::Value(*Params, Key, Value, false))
+	{
+		return Default;
+	}
+
+	TArray<FString> Entries;
+	Value.ParseIntoArray(Entries, TEXT(","));
+
+	TArray<T> List;
+	for (const FString& Entry : Entries)
+	{
+		T Parsed;
+		LexFromString(Parsed, *Entry);
+		List.Add(Parsed);
+	}
+	return List;
+}
+
+
+void UTimeBenchmarkListener::OnTimeChanged(FTimeDate NewTime)
+{
+	NumCalls++;
+}
+
+
+UTimeBenchmarkCommandlet::UTimeBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTimeBenchmarkCommandlet::Main(const FString& Params)
+{
+	const TArray<int32> ListenerCounts = ParseList<int32>(Params, TEXT("Listeners="), { 0, 10, 100, 1000, 10000 });
+	const TArray<int32> WorldCounts = ParseList<int32>(Params, TEXT("Worlds="), { 1, 4, 16 });
+	const TArray<float> Scales = ParseList<float>(Params, TEXT("Scales="), { 1.0f, 60.0f, 3600.0f });
+
+	int32 Frames = 1000;
+	int32 Iterations = 10000;
+	float DriftSeconds = 3600.0f;
+	double Threshold = 0.1;
+	FString Output = FPaths::ProjectSavedDir() / TEXT("TimePlugin") / TEXT("Benchmark.json");
+	FString Baseline;
+
+	FParse::Value(*Params, TEXT("Frames="), Frames);
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Repetitions="), Repetitions);
+	FParse::Value(*Params, TEXT("NoiseFloor="), NoiseFloor);
+	FParse::Value(*Params, TEXT("DriftSeconds="), DriftSeconds);
+	FParse::Value(*Params, TEXT("Threshold="), Threshold);
+	FParse::Value(*Params, TEXT("Output="), Output);
+	FParse::Value(*Params, TEXT("Baseline="), Baseline);
+
+	Frames = FMath::Max(Frames, 1);
+	Iterations = FMath::Max(Iterations, 1);
+	Repetitions = FMath::Max(Repetitions, 1);
+	Results = MakeShareable(new FJsonObject());
+
+	RunTickBenchmark(ListenerCounts, Scales, Frames);
+	RunWorldsBenchmark(WorldCounts, Frames);
+	RunSingletonBenchmark(Iterations);
+	RunDriftBenchmark(Scales, DriftSeconds);
+
+	TSharedRef<FJsonObject> Report = MakeShareable(new FJsonObject());
+	Report->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+	Report->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+	Report->SetObjectField(TEXT("Results"), Results);
+
+	int32 NumRegressions = 0;
+	if (!Baseline.IsEmpty())
+	{
+		NumRegressions = CompareWithBaseline(Baseline, Threshold);
+		Report->SetStringField(TEXT("Baseline"), Baseline);
+		Report->SetNumberField(TEXT("Regressions"), NumRegressions);
+	}
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	if (!FFileHelper::SaveStringToFile(Json, *Output))
+	{
+		UE_LOG(LogTimePluginEditor, Error, TEXT("%s:: Failed to write benchmark results to %s"), *PLUGIN_FUNC_LINE, *Output);
+		return 1;
+	}
+
+	UE_LOG(LogTimePluginEditor, Display, TEXT("%s:: Wrote benchmark results to %s"), *PLUGIN_FUNC_LINE, *Output);
+	return NumRegressions > 0 ? 1 : 0;
+}
+
+UWorld* UTimeBenchmarkCommandlet::CreateBenchmarkWorld()
+{
+	//InitWorld broadcasts OnPostWorldInitialization, so the plugin spawns the TimeManager here like in a real game
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	return World;
+}
+
+void UTimeBenchmarkCommandlet::DestroyBenchmarkWorld(UWorld* World)
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+ATimeManager* UTimeBenchmarkCommandlet::GetInitializedTimeManager(UWorld* World)
+{
+	ATimeManager* TimeManager = FTimePlugin::Get().GetSingletonActor(World);
+	if (TimeManager)
+	{
+		TimeManager->InitializeTime(TimeManager->CurrentLocalTime);
+	}
+	return TimeManager;
+}
+
+void UTimeBenchmarkCommandlet::RunTickBenchmark(const TArray<int32>& ListenerCounts, const TArray<float>& Scales, int32 Frames)
+{
+	UWorld* World = CreateBenchmarkWorld();
+	ATimeManager* TimeManager = GetInitializedTimeManager(World);
+	if (!TimeManager)
+	{
+		UE_LOG(LogTimePluginEditor, Error, TEXT("%s:: No TimeManager in the benchmark world, skipping"), *PLUGIN_FUNC_LINE);
+		DestroyBenchmarkWorld(World);
+		return;
+	}
+
+	for (int32 ListenerCount : ListenerCounts)
+	{
+		TimeManager->OnTimeChanged.Clear();
+		Listeners.Reset();
+		for (int32 i = 0; i < ListenerCount; i++)
+		{
+			UTimeBenchmarkListener* Listener = NewObject<UTimeBenchmarkListener>();
+			TimeManager->OnTimeChanged.AddDynamic(Listener, &UTimeBenchmarkListener::OnTimeChanged);
+			Listeners.Add(Listener);
+		}
+
+		for (float Scale : Scales)
+		{
+			TimeManager->TimeScaleMultiplier = Scale;
+
+			const TArray<double> Samples = Measure([&]()
+			{
+				for (int32 Frame = 0; Frame < Frames; Frame++)
+				{
+					TimeManager->Tick(BENCHMARK_DELTA_SECONDS);
+				}
+			}, Frames);
+
+			AddTimedResult(FString::Printf(TEXT("Tick/Listeners=%d/Scale=%g"), ListenerCount, Scale), Samples, TEXT("us/frame"));
+		}
+	}
+
+	TimeManager->OnTimeChanged.Clear();
+	Listeners.Reset();
+	DestroyBenchmarkWorld(World);
+}
+
+void UTimeBenchmarkCommandlet::RunWorldsBenchmark(const TArray<int32>& WorldCounts, int32 Frames)
+{
+	for (int32 WorldCount : WorldCounts)
+	{
+		TArray<UWorld*> Worlds;
+		TArray<ATimeManager*> TimeManagers;
+		TArray<double> CreateSamples;
+
+		//Run 0 is the warm-up, the worlds of the last run are kept for the tick benchmark
+		for (int32 Run = 0; Run <= Repetitions; Run++)
+		{
+			for (UWorld* World : Worlds)
+			{
+				DestroyBenchmarkWorld(World);
+			}
+			Worlds.Reset();
+
+			const double CreateStartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < WorldCount; i++)
+			{
+				Worlds.Add(CreateBenchmarkWorld());
+			}
+			const double CreateElapsed = FPlatformTime::Seconds() - CreateStartTime;
+
+			if (Run > 0)
+			{
+				CreateSamples.Add(CreateElapsed / FMath::Max(WorldCount, 1));
+			}
+		}
+
+		for (UWorld* World : Worlds)
+		{
+			if (ATimeManager* TimeManager = GetInitializedTimeManager(World))
+			{
+				TimeManagers.Add(TimeManager);
+			}
+		}
+
+		const TArray<double> TickSamples = Measure([&]()
+		{
+			for (int32 Frame = 0; Frame < Frames; Frame++)
+			{
+				for (ATimeManager* TimeManager : TimeManagers)
+				{
+					TimeManager->Tick(BENCHMARK_DELTA_SECONDS);
+				}
+			}
+		}, Frames);
+
+		AddTimedResult(FString::Printf(TEXT("CreateWorld/Worlds=%d"), WorldCount), CreateSamples, TEXT("us/world"));
+		AddTimedResult(FString::Printf(TEXT("Tick/Worlds=%d"), WorldCount), TickSamples, TEXT("us/frame"));
+
+		for (UWorld* World : Worlds)
+		{
+			DestroyBenchmarkWorld(World);
+		}
+	}
+}
+
+void UTimeBenchmarkCommandlet::RunSingletonBenchmark(int32 Iterations)
+{
+	FTimePlugin& Plugin = FTimePlugin::Get();
+	UWorld* World = CreateBenchmarkWorld();
+	const UWorld::InitializationValues IVS;
+
+	AddTimedResult(TEXT("GetSingletonActor"), Measure([&]()
+	{
+		for (int32 i = 0; i < Iterations; i++)
+		{
+			Plugin.GetSingletonActor(World);
+		}
+	}, Iterations), TEXT("us/call"));
+
+	//Actor already present, the path every editor and preview world takes
+	AddTimedResult(TEXT("InitSingletonActor/Existing"), Measure([&]()
+	{
+		for (int32 i = 0; i < Iterations; i++)
+		{
+			Plugin.InitSingletonActor(World, IVS);
+		}
+	}, Iterations), TEXT("us/call"));
+
+	//Actor missing, the path a freshly loaded game world takes. Only the spawn itself is timed, run 0 is the warm-up
+	TArray<double> SpawnSamples;
+	for (int32 Run = 0; Run <= Repetitions; Run++)
+	{
+		double SpawnElapsed = 0.0;
+		for (int32 i = 0; i < Iterations; i++)
+		{
+			for (TActorIterator<ATimeManager> ActorItr(World); ActorItr; ++ActorItr)
+			{
+				ActorItr->Destroy();
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			Plugin.InitSingletonActor(World, IVS);
+			SpawnElapsed += FPlatformTime::Seconds() - StartTime;
+		}
+
+		if (Run > 0)
+		{
+			SpawnSamples.Add(SpawnElapsed / Iterations);
+		}
+	}
+	AddTimedResult(TEXT("InitSingletonActor/Spawn"), SpawnSamples, TEXT("us/call"));
+
+	DestroyBenchmarkWorld(World);
+}
+
+void UTimeBenchmarkCommandlet::RunDriftBenchmark(const TArray<float>& Scales, float DriftSeconds)
+{
+	UWorld* World = CreateBenchmarkWorld();
+	ATimeManager* TimeManager = GetInitializedTimeManager(World);
+	if (!TimeManager)
+	{
+		UE_LOG(LogTimePluginEditor, Error, TEXT("%s:: No TimeManager in the benchmark world, skipping"), *PLUGIN_FUNC_LINE);
+		DestroyBenchmarkWorld(World);
+		return;
+	}
+	const int64 Frames = (int64)(DriftSeconds / BENCHMARK_DELTA_SECONDS);
+
+	for (float Scale : Scales)
+	{
+		TimeManager->TimeScaleMultiplier = Scale;
+		TimeManager->InitializeTime(FTimeDate());
+		const FDateTime StartTime = TimeManager->InternalTime;
+
+		for (int64 Frame = 0; Frame < Frames; Frame++)
+		{
+			TimeManager->IncrementTime(BENCHMARK_DELTA_SECONDS);
+		}
+
+		//Exact game time the clock should have advanced, accumulated in double
+		const double ExpectedSeconds = (double)Frames * BENCHMARK_DELTA_SECONDS * Scale;
+		const double ActualSeconds = (TimeManager->InternalTime - StartTime).GetTotalSeconds();
+
+		AddResult(FString::Printf(TEXT("Drift/Seconds=%g/Scale=%g"), DriftSeconds, Scale), FMath::Abs(ActualSeconds - ExpectedSeconds), TEXT("s"));
+	}
+
+	DestroyBenchmarkWorld(World);
+}
+
+TArray<double> UTimeBenchmarkCommandlet::Measure(TFunctionRef<void()> Body, int32 OpsPerRun)
+{
+	//Warm-up run, not recorded
+	Body();
+
+	TArray<double> Samples;
+	for (int32 Run = 0; Run < Repetitions; Run++)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Body();
+		Samples.Add((FPlatformTime::Seconds() - StartTime) / OpsPerRun);
+	}
+	return Samples;
+}
+
+void UTimeBenchmarkCommandlet::AddTimedResult(const FString& Name, TArray<double> SecondsPerOp, const FString& Unit)
+{
+	if (SecondsPerOp.Num() == 0)
+	{
+		return;
+	}
+
+	SecondsPerOp.Sort();
+	const double Median = SecondsPerOp[SecondsPerOp.Num() / 2] * 1000000.0;
+
+	//The fastest run is the least disturbed by the rest of the machine, so it is the value compared
+	TSharedRef<FJsonObject> Result = AddResult(Name, SecondsPerOp[0] * 1000000.0, Unit, NoiseFloor);
+	Result->SetNumberField(TEXT("Median"), Median);
+	Result->SetNumberField(TEXT("Runs"), SecondsPerOp.Num());
+}
+
+TSharedRef<FJsonObject> UTimeBenchmarkCommandlet::AddResult(const FString& Name, double Value, const FString& Unit, double ResultNoiseFloor)
+{
+	UE_LOG(LogTimePluginEditor, Display, TEXT("%s:: %s = %f %s"), *PLUGIN_FUNC_LINE, *Name, Value, *Unit);
+
+	TSharedRef<FJsonObject> Result = MakeShareable(new FJsonObject());
+	Result->SetNumberField(TEXT("Value"), Value);
+	Result->SetStringField(TEXT("Unit"), Unit);
+	Result->SetNumberField(TEXT("NoiseFloor"), ResultNoiseFloor);
+	Results->SetObjectField(Name, Result);
+	return Result;
+}
+
+int32 UTimeBenchmarkCommandlet::CompareWithBaseline(const FString& BaselinePath, double Threshold)
+{
+	FString Json;
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FFileHelper::LoadFileToString(Json, *BaselinePath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Baseline) || !Baseline.IsValid())
+	{
+		UE_LOG(LogTimePluginEditor, Warning, TEXT("%s:: Could not read baseline %s, skipping comparison"), *PLUGIN_FUNC_LINE, *BaselinePath);
+		return 0;
+	}
+
+	const TSharedPtr<FJsonObject>* BaselineResults;
+	if (!Baseline->TryGetObjectField(TEXT("Results"), BaselineResults))
+	{
+		return 0;
+	}
+
+	int32 NumRegressions = 0;
+	for (const auto& Entry : Results->Values)
+	{
+		const TSharedPtr<FJsonObject>* BaselineResult;
+		if (!(*BaselineResults)->TryGetObjectField(Entry.Key, BaselineResult))
+		{
+			continue;
+		}
+
+		//Every metric is lower-is-better
+		TSharedPtr<FJsonObject> Result = Entry.Value->AsObject();
+		const double Value = Result->GetNumberField(TEXT("Value"));
+		const double BaselineValue = (*BaselineResult)->GetNumberField(TEXT("Value"));
+
+		//Differences below the noise floor are timer jitter, not regressions
+		double ResultNoiseFloor = 0.0;
+		Result->TryGetNumberField(TEXT("NoiseFloor"), ResultNoiseFloor);
+		const bool bRegressed = Value > BaselineValue * (1.0 + Threshold) && Value - BaselineValue > ResultNoiseFloor;
+
+		Result->SetNumberField(TEXT("Baseline"), BaselineValue);
+		Result->SetBoolField(TEXT("Regressed"), bRegressed);
+
+		if (bRegressed)
+		{
+			UE_LOG(LogTimePluginEditor, Warning, TEXT("%s:: %s regressed: %f (baseline %f)"), *PLUGIN_FUNC_LINE, *Entry.Key, Value, BaselineValue);
+			NumRegressions++;
+		}
+	}
+	return NumRegressions;
+}
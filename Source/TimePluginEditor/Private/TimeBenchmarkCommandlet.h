@@ -0,0 +1,83 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "TimeDateStruct.h"
+#include "TimeBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+// Counts OnTimeChanged broadcasts, stands in for a gameplay listener
+UCLASS()
+class UTimeBenchmarkListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+		void OnTimeChanged(FTimeDate NewTime);
+
+	int32 NumCalls = 0;
+};
+
+/*
+*	Measures how the TimeManager scales and writes the results as JSON.
+*
+*	UE4Editor-Cmd MyProject -run=TimeBenchmark -nullrhi -unattended
+*		[-Listeners=0,10,100,1000,10000] [-Worlds=1,4,16] [-Scales=1,60,3600]
+*		[-Frames=1000] [-Iterations=10000] [-Repetitions=5] [-DriftSeconds=3600]
+*		[-Output=Path] [-Baseline=Path] [-Threshold=0.1] [-NoiseFloor=0.5]
+*
+*	Every result is keyed by name, e.g. "Tick/Listeners=1000/Scale=60". Timed results run once to warm up,
+*	then Repetitions times, and record the fastest run (plus the median) in microseconds. When a baseline
+*	JSON from an earlier run is given, results worse than baseline * (1 + Threshold) and by more than
+*	NoiseFloor microseconds are marked "Regressed" and the commandlet returns 1.
+*/
+UCLASS()
+class UTimeBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTimeBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	UWorld* CreateBenchmarkWorld();
+	void DestroyBenchmarkWorld(UWorld* World);
+	class ATimeManager* GetInitializedTimeManager(UWorld* World);
+
+	// ATimeManager::Tick cost per frame for each listener count and time scale
+	void RunTickBenchmark(const TArray<int32>& ListenerCounts, const TArray<float>& Scales, int32 Frames);
+
+	// Tick cost per frame when many worlds each run their own clock
+	void RunWorldsBenchmark(const TArray<int32>& WorldCounts, int32 Frames);
+
+	// FTimePlugin::GetSingletonActor and FTimePlugin::InitSingletonActor cost
+	void RunSingletonBenchmark(int32 Iterations);
+
+	// Difference between the clock and the exact elapsed game time after a long simulated run
+	void RunDriftBenchmark(const TArray<float>& Scales, float DriftSeconds);
+
+	// Runs Body once to warm up, then Repetitions times, returns the seconds per op of each timed run
+	TArray<double> Measure(TFunctionRef<void()> Body, int32 OpsPerRun);
+
+	void AddTimedResult(const FString& Name, TArray<double> SecondsPerOp, const FString& Unit);
+	TSharedRef<FJsonObject> AddResult(const FString& Name, double Value, const FString& Unit, double ResultNoiseFloor = 0.0);
+
+	// Returns the number of results that regressed against the baseline file
+	int32 CompareWithBaseline(const FString& BaselinePath, double Threshold);
+
+	UPROPERTY()
+		TArray<UTimeBenchmarkListener*> Listeners;
+
+	TSharedPtr<FJsonObject> Results;
+
+	int32 Repetitions = 5;
+
+	// Absolute slowdown in microseconds a timed result must exceed to count as a regression
+	double NoiseFloor = 0.5;
+};
@@ -0,0 +1,9 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#include "TimePluginEditor.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY(LogTimePluginEditor);
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, TimePluginEditor)
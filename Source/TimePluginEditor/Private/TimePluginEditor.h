@@ -0,0 +1,7 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+#pragma once
+
+//Editor only tools for the TimePlugin (almanac generation, benchmarks), kept out of packaged games
+DECLARE_LOG_CATEGORY_EXTERN(LogTimePluginEditor, Display, All);
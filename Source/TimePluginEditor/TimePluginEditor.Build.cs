@@ -0,0 +1,28 @@
+// For copyright see LICENSE in EnvironmentProject root dir, or:
+//https://github.com/UE4-OceanProject/OceanProject/blob/Master-Environment-Project/LICENSE
+
+using UnrealBuildTool;
+using System.IO;
+
+public class TimePluginEditor : ModuleRules
+{
+    public TimePluginEditor(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PublicIncludePaths.AddRange(new string[] { });
+
+        PrivateIncludePaths.AddRange(new string[] { });
+
+        PublicDependencyModuleNames.AddRange(new string[] {
+            "Core"
+		});
+
+        PrivateDependencyModuleNames.AddRange(new string[] {
+            "CoreUObject",
+            "Engine",
+            "Json",
+            "TimePlugin"
+		});
+
+        DynamicallyLoadedModuleNames.AddRange(new string[] { });
+    }
+}